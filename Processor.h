@@ -8,8 +8,14 @@
 
 using namespace std;
 
+// Size of a host cache line; CPUState is aligned to it so a VM's registers
+// never share a line with another VM's (or its own cold) data.
+const size_t CACHE_LINE_SIZE = 64;
+
 // Represents the state of the CPU, including registers and control bits.
-struct CPUState {
+// The registers touched on every instruction (GPRs, PC, HI, LO) come first
+// and start on a cache line boundary; the rarely used control bits follow.
+struct alignas(CACHE_LINE_SIZE) CPUState {
     uint32_t GPR[32]; // General Purpose Registers 0-31
     uint32_t PC;      // Program Counter
     uint32_t HI;      // High-order bits of multiplication result
@@ -19,6 +25,8 @@ struct CPUState {
     int IRQ;          // Interrupt ReQuest
 };
 
+static_assert(sizeof(CPUState) % CACHE_LINE_SIZE == 0, "CPUState must fill whole cache lines");
+
 // The Processor class simulates a MIPS-like CPU.
 // It contains the CPU state and methods to execute MIPS instructions.
 class Processor {
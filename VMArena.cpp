@@ -0,0 +1,99 @@
+#include "VMArena.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <type_traits>
+
+using namespace std;
+
+// The arena never runs VM destructors, so a VM must not own anything.
+static_assert(is_trivially_destructible<VirtualMachine>::value,
+              "VirtualMachine must not own memory outside its VMArena");
+
+// Adds `amount` to `total`, exiting if the arena size would overflow.
+static void add_arena_size(size_t& total, size_t amount) {
+    if (amount > SIZE_MAX - total) {
+        cerr << "Error: VM arena size overflows" << endl;
+        exit(EXIT_FAILURE);
+    }
+    total += amount;
+}
+
+// Copies `lines` into the arena at the given cursors and advances them.
+static LineTable pack_lines(const vector<string>& lines, size_t*& offsets, char*& text) {
+    LineTable table;
+    table.text = text;
+    table.offsets = offsets;
+    table.count = lines.size();
+
+    size_t position = 0;
+    for (const auto& line : lines) {
+        *offsets++ = position;
+        memcpy(text, line.data(), line.size());
+        text += line.size();
+        position += line.size();
+    }
+    *offsets++ = position;
+    return table;
+}
+
+// Loads every VM, sizes the arena from the loaded images, and builds the
+// VMs inside it. The images are only needed until they have been copied in.
+VMArena::VMArena(const vector<string>& config_files)
+    : block(nullptr), vms(nullptr), count(0) {
+    vector<VMImage> images;
+    images.reserve(config_files.size());
+    for (const auto& config_file : config_files) {
+        images.push_back(VirtualMachine::load_image(config_file));
+    }
+
+    if (images.size() > SIZE_MAX / sizeof(VirtualMachine)) {
+        cerr << "Error: Unable to allocate memory for " << images.size() << " VMs" << endl;
+        exit(EXIT_FAILURE);
+    }
+    size_t num_offsets = 0;
+    size_t text_bytes = 0;
+    for (const auto& image : images) {
+        add_arena_size(num_offsets, image.config.size() + 1);
+        add_arena_size(num_offsets, image.instructions.size() + 1);
+        for (const auto& line : image.config) add_arena_size(text_bytes, line.size());
+        for (const auto& line : image.instructions) add_arena_size(text_bytes, line.size());
+    }
+    if (num_offsets > SIZE_MAX / sizeof(size_t)) {
+        cerr << "Error: VM arena size overflows" << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    size_t bytes = images.size() * sizeof(VirtualMachine);
+    add_arena_size(bytes, num_offsets * sizeof(size_t));
+    add_arena_size(bytes, text_bytes);
+    if (posix_memalign(&block, alignof(VirtualMachine), bytes > 0 ? bytes : 1) != 0) {
+        cerr << "Error: Unable to allocate memory for " << images.size() << " VMs" << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    vms = static_cast<VirtualMachine*>(block);
+    size_t* offsets = reinterpret_cast<size_t*>(vms + images.size());
+    char* text = reinterpret_cast<char*>(offsets + num_offsets);
+    for (const auto& image : images) {
+        LineTable config = pack_lines(image.config, offsets, text);
+        LineTable program = pack_lines(image.instructions, offsets, text);
+        new (&vms[count]) VirtualMachine(config, program);
+        count++;
+    }
+}
+
+// VMs are trivially destructible and own nothing outside the block.
+VMArena::~VMArena() {
+    free(block);
+}
+
+VirtualMachine& VMArena::operator[](size_t index) {
+    return vms[index];
+}
+
+size_t VMArena::size() const {
+    return count;
+}
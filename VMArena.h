@@ -0,0 +1,32 @@
+#ifndef VM_ARENA_H
+#define VM_ARENA_H
+
+#include "VirtualMachine.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Holds a fleet of VMs in a single cache line aligned allocation: the VM
+// control blocks first, followed by the line offsets and text of every VM's
+// program and configuration. Nothing a VM uses at run time lives outside
+// the block, so tearing the fleet down is a single free.
+class VMArena {
+public:
+    explicit VMArena(const vector<string>& config_files);
+    ~VMArena();
+
+    VMArena(const VMArena&) = delete;
+    VMArena& operator=(const VMArena&) = delete;
+
+    VirtualMachine& operator[](size_t index);
+    size_t size() const;
+
+private:
+    void* block;
+    VirtualMachine* vms;
+    size_t count;
+};
+
+#endif
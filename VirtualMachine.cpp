@@ -4,6 +4,7 @@
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <map>
 #include <sstream>
 
 using namespace std;
@@ -18,15 +19,23 @@ void trim(string& s) {
     }).base(), s.end());
 }
 
-// Initializes a VM by loading its configuration and binary file.
-VirtualMachine::VirtualMachine(const string& config_file_path) {
-    load_config(config_file_path);
-    load_binary();
+// Initializes a VM over configuration and program text owned by its arena.
+VirtualMachine::VirtualMachine(const LineTable& config, const LineTable& program)
+    : program(program), config(config) {
     cpu.set_pc(0);
 }
 
-// Loads the VM's configuration from a file.
-void VirtualMachine::load_config(const string& config_file_path) {
+// Reads a VM's configuration and the binary it names into a VMImage.
+VMImage VirtualMachine::load_image(const string& config_file_path) {
+    VMImage image;
+    string binary_path = load_config(config_file_path, image);
+    load_binary(binary_path, image);
+    return image;
+}
+
+// Loads the VM's configuration from a file and returns the path of its binary.
+string VirtualMachine::load_config(const string& config_file_path, VMImage& image) {
+    string config_dir;
     size_t last_slash = config_file_path.find_last_of("/\\");
     if (string::npos != last_slash) {
         config_dir = config_file_path.substr(0, last_slash + 1);
@@ -40,6 +49,7 @@ void VirtualMachine::load_config(const string& config_file_path) {
         exit(EXIT_FAILURE);
     }
 
+    map<string, string> config;
     string line;
     int line_num = 0;
     while (getline(config_file, line)) {
@@ -59,17 +69,21 @@ void VirtualMachine::load_config(const string& config_file_path) {
             cerr << "Warning: Malformed line " << line_num << " in config file, skipping: \"" << line << "\"" << endl;
         }
     }
-}
 
-// Loads the machine code from the binary file specified in the configuration.
-void VirtualMachine::load_binary() {
+    for (const auto& pair : config) {
+        image.config.push_back(pair.first + " = " + pair.second);
+    }
+
     auto it = config.find("vm_binary");
     if (it == config.end()) {
         cerr << "Error: vm_binary not found in config" << endl;
         exit(EXIT_FAILURE);
     }
+    return config_dir + it->second;
+}
 
-    string binary_path = config_dir + it->second;
+// Loads the machine code from the binary file specified in the configuration.
+void VirtualMachine::load_binary(const string& binary_path, VMImage& image) {
     ifstream binary_file(binary_path);
     if (!binary_file.is_open()) {
         cerr << "Error: Unable to open binary file " << binary_path << endl;
@@ -79,28 +93,32 @@ void VirtualMachine::load_binary() {
     string line;
     while (getline(binary_file, line)) {
         trim(line); // Trim each line to remove extraneous whitespace and control characters
-        instructions.push_back(line);
+        image.instructions.push_back(line);
     }
 }
 
 // Prints the configuration of the VM.
 void VirtualMachine::print_config() {
-    for (const auto& pair : config) {
-        cout << "  " << pair.first << " = " << pair.second << endl;
+    for (size_t i = 0; i < config.count; ++i) {
+        cout << "  ";
+        cout.write(config.text + config.offsets[i], config.offsets[i + 1] - config.offsets[i]);
+        cout << endl;
     }
 }
 
 // The main execution loop of the virtual machine.
 bool VirtualMachine::run() {
-    while (cpu.get_pc() < instructions.size()) {
-        string instruction_line = instructions[cpu.get_pc()];
+    while (cpu.get_pc() < program.count) {
+        uint32_t pc = cpu.get_pc();
+        const char* line = program.text + program.offsets[pc];
+        size_t length = program.offsets[pc + 1] - program.offsets[pc];
 
         // If the line is empty after trimming, we've reached the end of the program.
-        if (instruction_line.empty()) {
+        if (length == 0) {
             return true; // Gracefully exit.
         }
 
-        if (!execute_instruction(instruction_line)) {
+        if (!execute_instruction(line, length)) {
             return false;
         }
         cpu.increment_pc();
@@ -109,8 +127,8 @@ bool VirtualMachine::run() {
 }
 
 // Parses and executes a single line of machine code.
-bool VirtualMachine::execute_instruction(const string& instruction_line) {
-    string temp_line = instruction_line;
+bool VirtualMachine::execute_instruction(const char* line, size_t length) {
+    string temp_line(line, length);
     std::replace(temp_line.begin(), temp_line.end(), ',', ' ');
 
     istringstream iss(temp_line);
@@ -2,28 +2,49 @@
 #define VIRTUAL_MACHINE_H
 
 #include "Processor.h"
+#include <cstddef>
 #include <string>
 #include <vector>
-#include <map>
 
 using namespace std;
 
+// A read-only list of lines stored back to back in one character buffer.
+// Line i is text[offsets[i]] up to text[offsets[i + 1]]; offsets holds
+// count + 1 entries. The storage is owned by the VMArena the VM lives in.
+struct LineTable {
+    const char* text;
+    const size_t* offsets;
+    size_t count;
+};
+
+// Configuration and program of a VM as read from disk, before it is
+// packed into a VMArena.
+struct VMImage {
+    vector<string> config;       // "key = value" entries, sorted by key
+    vector<string> instructions; // One trimmed line of the binary per entry
+};
+
 class VirtualMachine {
 public:
-    VirtualMachine(const string& config_file_path);
+    VirtualMachine(const LineTable& config, const LineTable& program);
     bool run(); // Returns true on success, false on failure
     void print_config();
     uint32_t get_current_pc() const;
 
+    static VMImage load_image(const string& config_file_path);
+
 private:
-    void load_config(const string& config_file_path);
-    void load_binary();
-    bool execute_instruction(const string& instruction_line);
+    static string load_config(const string& config_file_path, VMImage& image);
+    static void load_binary(const string& binary_path, VMImage& image);
+    bool execute_instruction(const char* line, size_t length);
 
-    map<string, string> config;
-    vector<string> instructions;
+    // Hot: registers first, then the program they step through. Both are
+    // read on every instruction.
     Processor cpu;
-    string config_dir;
+    LineTable program;
+
+    // Cold: only used by print_config().
+    LineTable config;
 };
 
 #endif
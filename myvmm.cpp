@@ -4,7 +4,7 @@
 #include <string>
 #include <fstream>
 
-#include "VirtualMachine.h"
+#include "VMArena.h"
 
 using namespace std;
 
@@ -28,10 +28,7 @@ int main(int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
-    vector<VirtualMachine> vms;
-    for (const auto& config_file : config_files) {
-        vms.emplace_back(config_file);
-    }
+    VMArena vms(config_files);
 
     cout << "\nStarting VM execution..." << endl;
     for (size_t i = 0; i < vms.size(); ++i) {